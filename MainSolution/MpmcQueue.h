@@ -0,0 +1,88 @@
+#ifndef MPMC_QUEUE_H1
+#define MPMC_QUEUE_H1
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+using namespace std;
+
+// Bounded lock-free multi-producer multi-consumer queue (Vyukov's array queue).
+//
+// Every cell carries a sequence number telling producers and consumers whose turn it is,
+// so a push or pop is one compare-and-swap on the shared position plus a release store
+// on the cell. Capacity is rounded up to a power of two.
+template<class T>
+class MpmcQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T value;
+    };
+
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePos;
+    alignas(64) atomic<size_t> dequeuePos;
+
+public:
+    explicit MpmcQueue(size_t capacity) : enqueuePos(0), dequeuePos(0) {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++)
+            cells[i].sequence.store(i, memory_order_relaxed);
+    } // Constructor
+
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    bool tryPush(T value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            ptrdiff_t diff = ptrdiff_t(sequence) - ptrdiff_t(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    } // Append value, false if the queue is full
+
+    bool tryPop(T &value) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        for (;;) {
+            Cell &cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            ptrdiff_t diff = ptrdiff_t(sequence) - ptrdiff_t(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    } // Take the oldest value, false if the queue is empty
+
+    size_t sizeApprox() const {
+        size_t head = dequeuePos.load(memory_order_relaxed), tail = enqueuePos.load(memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    } // Number of queued values, exact only when nobody is pushing or popping
+};
+
+#endif // MPMC_QUEUE_H
@@ -0,0 +1,135 @@
+#include "PiecewisePolynomial.h"
+#include "bits/stdc++.h"
+
+static const int lineDoubles = 64 / sizeof(double);
+
+PiecewisePolynomial::PiecewisePolynomial() {
+    breaks = {0, 1};
+    order = 1;
+    stride = 1;
+    coeffs.assign(stride, 0);
+    buildTree();
+}
+
+PiecewisePolynomial::PiecewisePolynomial(const vector<double> &breaks, const vector<Polynomial> &pieces) {
+    if (pieces.empty() || breaks.size() != pieces.size() + 1)
+        throw invalid_argument("PiecewisePolynomial needs one more breakpoint than pieces");
+    for (int i = 1; i < breaks.size(); i++)
+        if (!(breaks[i - 1] < breaks[i]))
+            throw invalid_argument("PiecewisePolynomial breakpoints must be strictly increasing");
+    int maxOrder = 1;
+    for (const Polynomial &p: pieces)
+        maxOrder = max(maxOrder, p.degree() + 1);
+    *this = zeros(breaks, maxOrder);
+    for (int i = 0; i < pieces.size(); i++) {
+        const vector<double> &c = pieces[i].getCoefficients();
+        copy(c.begin(), c.end(), coeffs.begin() + size_t(i) * stride);
+    }
+}
+
+PiecewisePolynomial PiecewisePolynomial::zeros(const vector<double> &breaks, int order) {
+    PiecewisePolynomial ans;
+    ans.breaks = breaks;
+    ans.order = max(1, order);
+    // Pad to a divisor of the cache line so that no piece straddles two lines
+    ans.stride = 1;
+    while (ans.stride < min(ans.order, lineDoubles))
+        ans.stride *= 2;
+    if (ans.order > lineDoubles)
+        ans.stride = (ans.order + lineDoubles - 1) / lineDoubles * lineDoubles;
+    ans.coeffs.assign(size_t(ans.stride) * (breaks.size() - 1), 0);
+    ans.buildTree();
+    return ans;
+}
+
+// Eytzinger layout
+
+void PiecewisePolynomial::buildTree() {
+    int n = max(0, int(breaks.size()) - 2);
+    tree.assign(n + 1, 0);
+    treeIndex.assign(n + 1, 0);
+    int next = 0;
+    fillTree(next, 1);
+}
+
+void PiecewisePolynomial::fillTree(int &next, int k) {
+    if (k >= tree.size())
+        return;
+    fillTree(next, 2 * k);
+    tree[k] = breaks[next + 1];
+    treeIndex[k] = ++next;
+    fillTree(next, 2 * k + 1);
+}
+
+int PiecewisePolynomial::segment(double x) const {
+    // Descend without branching on the comparison, then undo the trailing right turns
+    // to land on the first interior breakpoint greater than x
+    int n = int(tree.size()) - 1, k = 1;
+    while (k <= n)
+        k = 2 * k + (tree[k] <= x);
+    k >>= __builtin_ffs(~k);
+    return k == 0 ? n : treeIndex[k] - 1;
+} // Index of the piece used at x
+
+// Utility functions
+
+double PiecewisePolynomial::evaluatePiece(int i, double x) const {
+    const double *c = coeffs.data() + size_t(i) * stride;
+    double t = x - breaks[i], ans = 0;
+    for (int j = order - 1; j >= 0; j--)
+        ans = ans * t + c[j];
+    return ans;
+}
+
+int PiecewisePolynomial::pieces() const {
+    return int(breaks.size()) - 1;
+} // Number of pieces
+
+Polynomial PiecewisePolynomial::piece(int i) const {
+    auto begin = coeffs.begin() + size_t(i) * stride;
+    return Polynomial(vector<double>(begin, begin + order));
+} // Piece i in its local variable
+
+double PiecewisePolynomial::evaluate(double x) const {
+    return evaluatePiece(segment(x), x);
+} // Evaluate the spline at x
+
+void PiecewisePolynomial::evaluateSorted(const vector<double> &xs, vector<double> &out) const {
+    out.resize(xs.size());
+    int i = 0, last = pieces() - 1;
+    for (int j = 0; j < xs.size(); j++) {
+        while (i < last && breaks[i + 1] <= xs[j])
+            i++;
+        out[j] = evaluatePiece(i, xs[j]);
+    }
+} // Evaluate at ascending xs
+
+PiecewisePolynomial PiecewisePolynomial::derivative() const {
+    PiecewisePolynomial ans = zeros(breaks, order - 1);
+    for (int i = 0; i < pieces(); i++) {
+        const double *c = coeffs.data() + size_t(i) * stride;
+        double *d = ans.coeffs.data() + size_t(i) * ans.stride;
+        for (int j = 1; j < order; j++)
+            d[j - 1] = c[j] * j;
+    }
+    return ans;
+} // Derivative of every piece
+
+PiecewisePolynomial PiecewisePolynomial::integral() const {
+    PiecewisePolynomial ans = zeros(breaks, order + 1);
+    double start = 0;
+    for (int i = 0; i < pieces(); i++) {
+        const double *c = coeffs.data() + size_t(i) * stride;
+        double *d = ans.coeffs.data() + size_t(i) * ans.stride;
+        d[0] = start;
+        for (int j = 1; j <= order; j++)
+            d[j] = c[j - 1] / j;
+        start = ans.evaluatePiece(i, breaks[i + 1]);
+    }
+    return ans;
+} // Continuous antiderivative, zero at the first breakpoint
+
+double PiecewisePolynomial::integral(double x1, double x2) const {
+    PiecewisePolynomial antiderivative = integral();
+    return antiderivative.evaluate(x2) - antiderivative.evaluate(x1);
+} // Integrate from x1 to x2
@@ -0,0 +1,73 @@
+#ifndef PIECEWISE_POLYNOMIAL_H1
+#define PIECEWISE_POLYNOMIAL_H1
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "Polynomial.h"
+
+using namespace std;
+
+// Allocator returning Align-byte aligned storage
+template<class T, size_t Align = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template<class U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+    template<class U>
+    AlignedAllocator(const AlignedAllocator<U, Align> &) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T), align_val_t(Align))); }
+    void deallocate(T *p, size_t) { ::operator delete(p, align_val_t(Align)); }
+
+    template<class U>
+    bool operator==(const AlignedAllocator<U, Align> &) const { return true; }
+    template<class U>
+    bool operator!=(const AlignedAllocator<U, Align> &) const { return false; }
+};
+
+// Spline made of one polynomial per interval [breaks[i], breaks[i + 1]].
+//
+// Piece i is written in the local variable x - breaks[i]; a piece written in x itself
+// converts with piece.taylorShift(breaks[i]). All pieces live in one 64-byte aligned
+// buffer with a stride of 1, 2, 4 or 8 doubles (whole cache lines past 8), so a piece
+// never straddles a line and a cubic spline packs two pieces per line. Segments are
+// found by a branch-free search over the interior breakpoints stored in Eytzinger
+// (breadth-first) order.
+// Queries left of the first or right of the last breakpoint extend the end pieces.
+class PiecewisePolynomial {
+private:
+    vector<double> breaks; // Sorted breakpoints, one more than the number of pieces
+    vector<double, AlignedAllocator<double>> coeffs; // Piece i starts at i * stride
+    int order; // Coefficients used per piece
+    int stride; // order rounded up to a divisor or multiple of the cache line
+    vector<double> tree; // Interior breakpoints in Eytzinger order, 1-based
+    vector<int> treeIndex; // Number of interior breakpoints up to and including tree[k]
+
+    static PiecewisePolynomial zeros(const vector<double> &breaks, int order); // Zeroed pieces
+    void buildTree(); // Lay out tree and treeIndex from breaks
+    void fillTree(int &next, int k); // In-order walk filling tree[k]
+    double evaluatePiece(int i, double x) const; // Horner on piece i at x
+
+public:
+    // Constructors
+    PiecewisePolynomial(); // Default constructor, the zero polynomial on [0, 1]
+    PiecewisePolynomial(const vector<double> &breaks, const vector<Polynomial> &pieces); // Constructor with pieces
+
+    // Utility functions
+    int pieces() const; // Number of pieces
+    int segment(double x) const; // Index of the piece used at x
+    Polynomial piece(int i) const; // Piece i in its local variable
+    double evaluate(double x) const; // Evaluate the spline at x
+    void evaluateSorted(const vector<double> &xs, vector<double> &out) const; // Evaluate at ascending xs
+    PiecewisePolynomial derivative() const; // Derivative of every piece
+    PiecewisePolynomial integral() const; // Continuous antiderivative, zero at the first breakpoint
+    double integral(double x1, double x2) const; // Integrate from x1 to x2
+};
+
+#endif // PIECEWISE_POLYNOMIAL_H
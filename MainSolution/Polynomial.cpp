@@ -1,13 +1,23 @@
 #include "Polynomial.h"
 #include "bits/stdc++.h"
 
+// Replace the n + 1 coefficients in c by those of p(x + shift) with repeated synthetic division
+static void taylorShiftInPlace(double *c, int n, double shift) {
+    for (int i = 0; i < n; i++)
+        for (int j = n - 1; j >= i; j--)
+            c[j] += shift * c[j + 1];
+}
 
 Polynomial::Polynomial() {
-    coeffs = {0};
+    coeffs = make_shared<const vector<double>>(1, 0);
 }
 
 Polynomial::Polynomial(const vector<double> &coefficients) {
-    coeffs = coefficients;
+    coeffs = make_shared<const vector<double>>(coefficients);
+}
+
+Polynomial::Polynomial(vector<double> &&coefficients) {
+    coeffs = make_shared<const vector<double>>(std::move(coefficients));
 }
 
 Polynomial::Polynomial(const Polynomial &other) {
@@ -24,85 +34,63 @@ Polynomial &Polynomial::operator=(const Polynomial &other) {
 }
 
 // Arithmetic operators
-Polynomial Polynomial::operator+(const Polynomial &other) const {
-    Polynomial ans = *this;
-    while (ans.coeffs.size() < other.coeffs.size())
-        ans.coeffs.push_back(0);
-    for (int i = 0; i < other.coeffs.size(); i++)
-        ans.coeffs[i] += other.coeffs[i];
-    return ans;
-}
-
-Polynomial Polynomial::operator-(const Polynomial &other) const {
-    Polynomial ans = *this;
-    while (ans.coeffs.size() < other.coeffs.size())
-        ans.coeffs.push_back(0);
-    for (int i = 0; i < other.coeffs.size(); i++)
-        ans.coeffs[i] -= other.coeffs[i];
-    return ans;
-}
-
-Polynomial Polynomial::operator*(const Polynomial &other) const {
-    Polynomial ans(vector<double>(coeffs.size() + other.coeffs.size() - 1, 0));
-    for (int i = 0; i < coeffs.size(); i++)
-        for (int j = 0; j < other.coeffs.size(); j++)
-            ans.coeffs[i + j] += coeffs[i] * other.coeffs[j];
-    return ans;
+Polynomial operator*(const Polynomial &x, const Polynomial &y) {
+    const vector<double> &a = *x.coeffs, &b = *y.coeffs;
+    vector<double> ans(a.size() + b.size() - 1, 0);
+    for (int i = 0; i < a.size(); i++)
+        for (int j = 0; j < b.size(); j++)
+            ans[i + j] += a[i] * b[j];
+    return Polynomial(std::move(ans));
 }
 
 // Equality operator
-bool Polynomial::operator==(const Polynomial &other) const {
-    return coeffs == other.coeffs;
+bool operator==(const Polynomial &a, const Polynomial &b) {
+    return a.coeffs == b.coeffs || *a.coeffs == *b.coeffs;
 }
 
 // Output operator
 ostream &operator<<(ostream &out, const Polynomial &poly) {
-    for (double i: poly.coeffs)
+    for (double i: *poly.coeffs)
         out << i << ' ';
     return out;
 }
 
 // Utility functions
 int Polynomial::degree() const {
-    return int(coeffs.size()) - 1;
+    return int(coeffs->size()) - 1;
 } // Return the degree of the polynomial
 double Polynomial::evaluate(double x) const {
-    double ans = 0;
-    for (int i = 0; i < coeffs.size(); i++)
-        ans += coeffs[i] * pow(x, i);
-    return ans;
+    return view().evaluate(x);
 }; // Evaluate the polynomial at x
+void Polynomial::evaluateWithDerivatives(double x, int k, double *out) const {
+    view().evaluateWithDerivatives(x, k, out);
+} // out[j] = j-th derivative at x, j <= k
 Polynomial Polynomial::compose(const Polynomial &q) const {
     Polynomial ans, powerOfQ({1.0});
-    for (double coeff: coeffs) {
-        ans = ans + powerOfQ * Polynomial({coeff});
+    for (double coeff: *coeffs) {
+        ans = ans + coeff * powerOfQ;
         powerOfQ = powerOfQ * q;
     }
     return ans;
 }; // Composition
 Polynomial Polynomial::derivative() const {
-    if (degree() == 0)
-        return Polynomial();
-    Polynomial ans(vector<double>(max(1, int(coeffs.size()) - 1), 0));
-    for (int i = 0; i < ans.coeffs.size(); i++)
-        ans.coeffs[i] = coeffs[i + 1] * (i + 1);
-    return ans;
+    return view().derivative();
 } // Derivative of the polynomial
 Polynomial Polynomial::integral() const {
-    Polynomial ans(vector<double>(coeffs.size() + 1, 0));
-    for (int i = 1; i < ans.coeffs.size(); i++)
-        ans.coeffs[i] = coeffs[i - 1] / i;
-    return ans;
+    return view().integral();
 } // Return a polynomial of integration
 double Polynomial::integral(double x1, double x2) const {
-    return integral().evaluate(x2) - integral().evaluate(x1);
+    return view().integral(x1, x2);
 } // Integrate from x1 to x2
+Polynomial Polynomial::taylorShift(double c) const {
+    return view().taylorShift(c);
+} // Return p(x + c)
 double Polynomial::getRoot(double guess, double tolerance, int maxIter) const {
-    double x = guess;
-    Polynomial deriv = derivative();
+    double x = guess, f[2];
     for (int i = 0; i < maxIter; ++i) {
-        double fx = evaluate(x);
-        double fpx = deriv.evaluate(x);
+        evaluateWithDerivatives(x, 1, f);
+        double fx = f[0];
+        double fpx = f[1];
         if (fabs(fx) < tolerance) {
             return x;
         }
@@ -113,12 +101,260 @@ double Polynomial::getRoot(double guess, double tolerance, int maxIter) const {
 
 // Set coefficients
 void Polynomial::setCoefficients(const vector<double> &coefficients) {
-    coeffs = coefficients;
+    coeffs = make_shared<const vector<double>>(coefficients);
+}
+
+
+// PolynomialView
+
+PolynomialView::PolynomialView(const double *coefficients, size_t count) {
+    data = coefficients;
+    size = int(count);
+}
+
+PolynomialView::PolynomialView(const vector<double> &coefficients) {
+    data = coefficients.data();
+    size = int(coefficients.size());
+}
+
+#ifdef __cpp_lib_span
+PolynomialView::PolynomialView(span<const double> coefficients) {
+    data = coefficients.data();
+    size = int(coefficients.size());
+}
+#endif
+
+int PolynomialView::degree() const {
+    return size - 1;
+} // Return the degree of the polynomial
+double PolynomialView::evaluate(double x) const {
+    double ans = 0;
+    for (int i = 0; i < size; i++)
+        ans += data[i] * pow(x, i);
+    return ans;
+} // Evaluate the polynomial at x
+void PolynomialView::evaluateWithDerivatives(double x, int k, double *out) const {
+    if (k < 0)
+        return; // Nothing asked for, and out may have no room at all
+    // Horner on k + 1 rows at once: row j accumulates the j-th derivative divided by j!
+    for (int j = 0; j <= k; j++)
+        out[j] = 0;
+    for (int i = size - 1; i >= 0; i--) {
+        for (int j = k; j >= 1; j--)
+            out[j] = out[j] * x + out[j - 1];
+        out[0] = out[0] * x + data[i];
+    }
+    double factorial = 1;
+    for (int j = 2; j <= k; j++) {
+        factorial *= j;
+        out[j] *= factorial;
+    }
+} // out[j] = j-th derivative at x, j <= k
+Polynomial PolynomialView::derivative() const {
+    if (size <= 1)
+        return Polynomial();
+    vector<double> ans(size - 1);
+    for (int i = 0; i < ans.size(); i++)
+        ans[i] = data[i + 1] * (i + 1);
+    return Polynomial(std::move(ans));
+} // Derivative of the polynomial
+Polynomial PolynomialView::integral() const {
+    vector<double> ans(size + 1, 0);
+    for (int i = 1; i < ans.size(); i++)
+        ans[i] = data[i - 1] / i;
+    return Polynomial(std::move(ans));
+} // Return a polynomial of integration
+double PolynomialView::integral(double x1, double x2) const {
+    double ans = 0;
+    for (int i = 0; i < size; i++)
+        ans += data[i] / (i + 1) * (pow(x2, i + 1) - pow(x1, i + 1));
+    return ans;
+} // Integrate from x1 to x2
+Polynomial PolynomialView::taylorShift(double c) const {
+    // Synthetic division is O(n^2) but stays at a few ulps of the coefficient size. The
+    // O(n log n) convolution forms lose every significant digit in double past degree ~60.
+    vector<double> ans(data, data + size);
+    taylorShiftInPlace(ans.data(), size - 1, c);
+    return Polynomial(std::move(ans));
+} // Return p(x + c)
+
+// Bernstein form
+
+// Rewrite the n + 1 monomial coefficients in c as Bernstein control points on [a, b]
+static void toBernsteinInPlace(double *c, int n, double a, double b) {
+    // Shift to q(t) = p(a + t)
+    taylorShiftInPlace(c, n, a);
+    // Scale to q(t) = p(a + (b - a) t) and divide by C(n, i)
+    double h = b - a, power = 1, binom = 1;
+    for (int i = 0; i <= n; i++) {
+        c[i] *= power / binom;
+        power *= h;
+        binom = binom * (n - i) / (i + 1);
+    }
+    // Control point k is the sum over i of C(k, i) * c[i]
+    for (int j = 1; j <= n; j++)
+        for (int k = n; k >= j; k--)
+            c[k] += c[k - 1];
 }
 
-// Get coefficient of a specific degree
-double Polynomial::getCoefficient(int degree) const {
-    if (degree < 0 || degree >= coeffs.size())
-        return 0;
-    return coeffs[degree];
+static const double unitRoundoff = numeric_limits<double>::epsilon() / 2;
+
+// Bernstein control points with rounding error bounds for count polynomials at once.
+//
+// The n + 1 coefficients are packed coefficient-major: coefficient j of polynomial p is
+// c[j * count + p], and ctrl and err use the same layout. Every step loops over the
+// polynomials innermost, so each step is one independent operation per lane.
+//
+// Control point k is exact for some interval [a, a + h] containing [a, b] up to err[k]:
+// h is rounded up, and err comes from running the same steps on absolute values, which
+// bounds the rounding error of every step by gamma(K) times that sum for K roundings.
+static void bernsteinWithError(const double *c, int n, int count, const double *a, const double *b,
+                               double *ctrl, double *err) {
+    vector<double> start(count), h(count), power(count, 1.0), absStart(count);
+    for (int p = 0; p < count; p++) {
+        start[p] = min(a[p], b[p]);
+        absStart[p] = fabs(start[p]);
+        h[p] = nextafter(nextafter(fabs(b[p] - a[p]), HUGE_VAL), HUGE_VAL);
+    }
+    int size = (n + 1) * count;
+    for (int i = 0; i < size; i++) {
+        ctrl[i] = c[i];
+        err[i] = fabs(c[i]);
+    }
+    // Shift to q(t) = p(a + t)
+    for (int i = 0; i < n; i++)
+        for (int j = n - 1; j >= i; j--) {
+            double *w = ctrl + j * count, *m = err + j * count;
+            const double *wNext = w + count, *mNext = m + count;
+            for (int p = 0; p < count; p++) {
+                w[p] += start[p] * wNext[p];
+                m[p] += absStart[p] * mNext[p];
+            }
+        }
+    // Scale to q(t) = p(a + h t) and divide by C(n, i)
+    double binom = 1;
+    for (int i = 0; i <= n; i++) {
+        double *w = ctrl + i * count, *m = err + i * count;
+        for (int p = 0; p < count; p++) {
+            double factor = power[p] / binom;
+            w[p] *= factor;
+            m[p] *= factor;
+            power[p] *= h[p];
+        }
+        binom = binom * (n - i) / (i + 1);
+    }
+    // Control point k is the sum over i of C(k, i) * c[i]
+    for (int j = 1; j <= n; j++)
+        for (int k = n; k >= j; k--) {
+            double *w = ctrl + k * count, *m = err + k * count;
+            const double *wPrev = w - count, *mPrev = m - count;
+            for (int p = 0; p < count; p++) {
+                w[p] += wPrev[p];
+                m[p] += mPrev[p];
+            }
+        }
+    // Each control point sees at most 2n roundings in the shift, 3n + 2 in the scale and
+    // n in the sums. gamma(K) = K u / (1 - K u) is covered by 2 K u while K u < 1/2, the
+    // extra terms cover the rounding of this bound and of ctrl -+ err in the caller.
+    double K = 8.0 * n + 8, gamma = 2 * K * unitRoundoff * (1 + 4 * unitRoundoff);
+    for (int i = 0; i < size; i++)
+        err[i] = gamma * err[i] + 2 * unitRoundoff * fabs(ctrl[i]) + numeric_limits<double>::min();
 }
+
+static bool bernsteinNoRoot(const vector<double> &ctrl, const vector<double> &err, int depth) {
+    bool positive = true, negative = true;
+    for (int k = 0; k < ctrl.size(); k++) {
+        positive &= ctrl[k] > err[k];
+        negative &= ctrl[k] < -err[k];
+    }
+    if (positive || negative)
+        return true;
+    if (depth == 0)
+        return false;
+    // Split at t = 1/2, each midpoint 0.5 * (x + y) rounds once
+    int n = int(ctrl.size()) - 1;
+    vector<double> row = ctrl, rowErr = err;
+    vector<double> left(n + 1), right(n + 1), leftErr(n + 1), rightErr(n + 1);
+    for (int r = 0; r <= n; r++) {
+        left[r] = row[0], leftErr[r] = rowErr[0];
+        right[n - r] = row[n - r], rightErr[n - r] = rowErr[n - r];
+        for (int k = 0; k < n - r; k++) {
+            row[k] = 0.5 * (row[k] + row[k + 1]);
+            rowErr[k] = 0.5 * (rowErr[k] + rowErr[k + 1]) * (1 + 4 * unitRoundoff) +
+                        2 * unitRoundoff * fabs(row[k]) + numeric_limits<double>::min();
+        }
+    }
+    return bernsteinNoRoot(left, leftErr, depth - 1) && bernsteinNoRoot(right, rightErr, depth - 1);
+}
+
+vector<double> Polynomial::toBernstein(double a, double b) const {
+    vector<double> ctrl = *coeffs;
+    if (ctrl.empty())
+        ctrl = {0};
+    toBernsteinInPlace(ctrl.data(), int(ctrl.size()) - 1, a, b);
+    return ctrl;
+} // Control points of the polynomial on [a, b]
+
+void Polynomial::subdivide(const vector<double> &ctrl, double t, vector<double> &left, vector<double> &right) {
+    int n = int(ctrl.size()) - 1;
+    vector<double> row = ctrl;
+    left.assign(ctrl.size(), 0);
+    right.assign(ctrl.size(), 0);
+    for (int r = 0; r <= n; r++) {
+        left[r] = row[0];
+        right[n - r] = row[n - r];
+        for (int k = 0; k < n - r; k++)
+            row[k] += t * (row[k + 1] - row[k]);
+    }
+} // de Casteljau split of control points at t in [0, 1]
+
+pair<double, double> Polynomial::rangeBound(double a, double b) const {
+    double lo, hi;
+    rangeBound(this, 1, &a, &b, &lo, &hi);
+    return {lo, hi};
+} // Guaranteed enclosure of p(x) for x in [a, b]
+
+void Polynomial::rangeBound(const double *coeffs, int size, int count, const double *a, const double *b,
+                            double *lo, double *hi) {
+    int n = max(1, size) - 1;
+    vector<double> ctrl((n + 1) * count), err((n + 1) * count, 0.0);
+    if (size == 0)
+        fill(ctrl.begin(), ctrl.end(), 0.0);
+    else
+        bernsteinWithError(coeffs, n, count, a, b, ctrl.data(), err.data());
+    for (int p = 0; p < count; p++) {
+        lo[p] = ctrl[p] - err[p];
+        hi[p] = ctrl[p] + err[p];
+    }
+    for (int k = 1; k <= n; k++) {
+        const double *w = ctrl.data() + k * count, *e = err.data() + k * count;
+        for (int p = 0; p < count; p++) {
+            double down = w[p] - e[p], up = w[p] + e[p];
+            lo[p] = down < lo[p] ? down : lo[p];
+            hi[p] = up > hi[p] ? up : hi[p];
+        }
+    }
+} // Batched guaranteed enclosures over coefficient-major packed coefficients
+
+void Polynomial::rangeBound(const Polynomial *polys, int count, const double *a, const double *b,
+                            double *lo, double *hi) {
+    // Pad to a common size, leading zero coefficients leave every enclosure valid
+    int size = 1;
+    for (int p = 0; p < count; p++)
+        size = max(size, int(polys[p].coeffs->size()));
+    vector<double> packed(size_t(size) * count, 0.0);
+    for (int p = 0; p < count; p++) {
+        const vector<double> &c = *polys[p].coeffs;
+        for (int j = 0; j < c.size(); j++)
+            packed[size_t(j) * count + p] = c[j];
+    }
+    rangeBound(packed.data(), size, count, a, b, lo, hi);
+} // Batched guaranteed enclosures, one per polynomial
+
+bool Polynomial::noRootIn(double a, double b, int maxDepth) const {
+    int n = max(1, int(coeffs->size())) - 1;
+    vector<double> c(n + 1, 0.0), ctrl(n + 1), err(n + 1);
+    copy(coeffs->begin(), coeffs->end(), c.begin());
+    bernsteinWithError(c.data(), n, 1, &a, &b, ctrl.data(), err.data());
+    return bernsteinNoRoot(ctrl, err, maxDepth);
+} // True if p is proven root free on [a, b]
@@ -1,35 +1,78 @@
 #ifndef POLYNOMIAL_H1
 #define POLYNOMIAL_H1
 
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if __has_include(<span>)
+#include <span>
+#endif
+
 using namespace std;
 
+template<class T>
+struct isPolynomialExpr : false_type {}; // True for the lazy expression nodes below
+
+class Polynomial;
+
+// Read-only polynomial over coefficients owned by someone else, lowest degree first
+class PolynomialView {
+private:
+    const double *data;
+    int size;
+
+public:
+    // Constructors
+    PolynomialView(const double *coefficients, size_t count); // View over a raw buffer
+    PolynomialView(const vector<double> &coefficients); // View over a vector
+#ifdef __cpp_lib_span
+    PolynomialView(span<const double> coefficients); // View over a span
+#endif
+
+    // Utility functions
+    int degree() const; // Return the degree of the polynomial
+    double evaluate(double x) const; // Evaluate the polynomial at x
+    void evaluateWithDerivatives(double x, int k, double *out) const; // out[j] = j-th derivative at x, j <= k
+    Polynomial derivative() const; // Derivative of the polynomial
+    Polynomial integral() const; // Return a polynomial of integration
+    double integral(double x1, double x2) const; // Integrate from x1 to x2
+    Polynomial taylorShift(double c) const; // Return p(x + c)
+    double getCoefficient(int degree) const; // Get coefficient of a specific degree
+    void addTo(double *out, double scale) const; // out[i] += scale * coefficient i
+};
 
 class Polynomial {
 private:
-    vector<double> coeffs; // Store coefficients of the polynomial
+    // Coefficients shared between copies. They are never changed in place, every
+    // writer installs a new vector, so copying a Polynomial is only a reference bump.
+    shared_ptr<const vector<double>> coeffs;
 
 public:
     // Constructors
     Polynomial(); // Default constructor
     Polynomial(const vector<double> &coefficients); // Constructor with coefficients
+    Polynomial(vector<double> &&coefficients); // Constructor taking over the coefficients
     Polynomial(const Polynomial &other); // Copy constructor
+    template<class E, class = enable_if_t<isPolynomialExpr<E>::value>>
+    Polynomial(const E &expr); // Materialize a lazy expression
 
     // Destructor
     ~Polynomial(); // Destructor
 
     // Assignment operator
     Polynomial &operator=(const Polynomial &other);
+    template<class E, class = enable_if_t<isPolynomialExpr<E>::value>>
+    Polynomial &operator=(const E &expr); // Materialize a lazy expression
 
-    // Arithmetic operators
-    Polynomial operator+(const Polynomial &other) const; // Addition
-    Polynomial operator-(const Polynomial &other) const; // Subtraction
-    Polynomial operator*(const Polynomial &other) const; // Multiplication
+    // Arithmetic operators (+, - and scalar * are lazy, see below)
+    friend Polynomial operator*(const Polynomial &a, const Polynomial &b); // Multiplication
 
     // Equality operator
-    bool operator==(const Polynomial &other) const; // Equality check
+    friend bool operator==(const Polynomial &a, const Polynomial &b); // Equality check
 
     // Output operator
     friend ostream &operator<<(ostream &out, const Polynomial &poly);
@@ -37,15 +80,192 @@ public:
     // Utility functions
     int degree() const; // Return the degree of the polynomial
     double evaluate(double x) const; // Evaluate the polynomial at x
+    void evaluateWithDerivatives(double x, int k, double *out) const; // out[j] = j-th derivative at x, j <= k
     Polynomial compose(const Polynomial &q) const; // Composition
     Polynomial derivative() const; // Derivative of the polynomial
     Polynomial integral() const; // Return a polynomial of integration
     double integral(double x1, double x2) const; // Integrate from x1 to x2
+    Polynomial taylorShift(double c) const; // Return p(x + c)
     double getRoot(double guess = 1, double tolerance = 1e-6, int maxIter = 100) const; // Find root
 
+    // Bernstein form
+    vector<double> toBernstein(double a, double b) const; // Control points of the polynomial on [a, b]
+    static void subdivide(const vector<double> &ctrl, double t, vector<double> &left,
+                          vector<double> &right); // de Casteljau split of control points at t in [0, 1]
+    pair<double, double> rangeBound(double a, double b) const; // Guaranteed enclosure of p(x) for x in [a, b]
+    static void rangeBound(const double *coeffs, int size, int count, const double *a, const double *b,
+                           double *lo, double *hi); // Batched, coefficient j of polynomial p at coeffs[j * count + p]
+    static void rangeBound(const Polynomial *polys, int count, const double *a, const double *b,
+                           double *lo, double *hi); // Batched guaranteed enclosures, one per polynomial
+    bool noRootIn(double a, double b, int maxDepth = 16) const; // True if p is proven root free on [a, b]
+
     // Set coefficients
     void setCoefficients(const vector<double> &coefficients); // Set coefficients
     double getCoefficient(int degree) const; // Get coefficient of a specific degree
+    const vector<double> &getCoefficients() const; // Get all coefficients, lowest degree first
+    PolynomialView view() const; // Read-only view over the coefficients
+    void addTo(double *out, double scale) const; // out[i] += scale * coefficient i
+};
+
+// Non-member so that lazy expressions convert on either side
+Polynomial operator*(const Polynomial &a, const Polynomial &b); // Multiplication
+bool operator==(const Polynomial &a, const Polynomial &b); // Equality check
+
+// Lazy linear expressions
+//
+// a + b - c + 2 * d builds a tree of nodes holding its operands, by reference for lvalues
+// and by value for temporaries. Nothing is computed until the tree is assigned to a
+// Polynomial, which zero-fills one vector of the final size and lets every leaf add its
+// scaled coefficients in one contiguous loop. Evaluating the tree at x walks the operands
+// directly and does not allocate. The rest of the read-only Polynomial API is available
+// on a node too; it materializes the node first.
+
+template<class T>
+using polynomialOperand = conditional_t<is_lvalue_reference<T>::value,
+        const decay_t<T> &, decay_t<T>>; // How a node stores an operand
+
+template<class T>
+struct isPolynomialOperand
+        : integral_constant<bool, is_same<T, Polynomial>::value || is_same<T, PolynomialView>::value ||
+                                  isPolynomialExpr<T>::value> {
+};
+
+template<class E>
+class PolynomialExpr {
+private:
+    Polynomial materialize() const { return Polynomial(static_cast<const E &>(*this)); }
+
+public:
+    void evaluateWithDerivatives(double x, int k, double *out) const {
+        materialize().evaluateWithDerivatives(x, k, out);
+    } // out[j] = j-th derivative at x, j <= k
+    Polynomial compose(const Polynomial &q) const { return materialize().compose(q); } // Composition
+    Polynomial derivative() const { return materialize().derivative(); } // Derivative of the polynomial
+    Polynomial integral() const { return materialize().integral(); } // Return a polynomial of integration
+    double integral(double x1, double x2) const { return materialize().integral(x1, x2); } // Integrate from x1 to x2
+    Polynomial taylorShift(double c) const { return materialize().taylorShift(c); } // Return p(x + c)
+    double getRoot(double guess = 1, double tolerance = 1e-6, int maxIter = 100) const {
+        return materialize().getRoot(guess, tolerance, maxIter);
+    } // Find root
+    vector<double> toBernstein(double a, double b) const { return materialize().toBernstein(a, b); } // Control points on [a, b]
+    pair<double, double> rangeBound(double a, double b) const { return materialize().rangeBound(a, b); } // Enclosure on [a, b]
+    bool noRootIn(double a, double b, int maxDepth = 16) const {
+        return materialize().noRootIn(a, b, maxDepth);
+    } // True if proven root free on [a, b]
+    vector<double> getCoefficients() const { return materialize().getCoefficients(); } // Get all coefficients
 };
 
+template<class L, class R, int Sign>
+class PolynomialSum : public PolynomialExpr<PolynomialSum<L, R, Sign>> {
+private:
+    L l;
+    R r;
+
+public:
+    PolynomialSum(L left, R right) : l(std::forward<L>(left)), r(std::forward<R>(right)) {}
+
+    int degree() const { return max(l.degree(), r.degree()); } // Degree of the result
+    double getCoefficient(int degree) const {
+        return l.getCoefficient(degree) + Sign * r.getCoefficient(degree);
+    } // Coefficient of the result
+    double evaluate(double x) const { return l.evaluate(x) + Sign * r.evaluate(x); } // Value at x
+    void addTo(double *out, double scale) const {
+        l.addTo(out, scale);
+        r.addTo(out, Sign * scale);
+    } // out[i] += scale * coefficient i
+};
+
+template<class E>
+class PolynomialScaled : public PolynomialExpr<PolynomialScaled<E>> {
+private:
+    double s;
+    E e;
+
+public:
+    PolynomialScaled(double scale, E expr) : s(scale), e(std::forward<E>(expr)) {}
+
+    int degree() const { return e.degree(); } // Degree of the result
+    double getCoefficient(int degree) const { return s * e.getCoefficient(degree); } // Coefficient of the result
+    double evaluate(double x) const { return s * e.evaluate(x); } // Value at x
+    void addTo(double *out, double scale) const { e.addTo(out, s * scale); } // out[i] += scale * coefficient i
+};
+
+template<class L, class R, int Sign>
+struct isPolynomialExpr<PolynomialSum<L, R, Sign>> : true_type {};
+
+template<class E>
+struct isPolynomialExpr<PolynomialScaled<E>> : true_type {};
+
+template<class L, class R, class = enable_if_t<
+        isPolynomialOperand<decay_t<L>>::value && isPolynomialOperand<decay_t<R>>::value>>
+PolynomialSum<polynomialOperand<L>, polynomialOperand<R>, 1> operator+(L &&l, R &&r) {
+    return {std::forward<L>(l), std::forward<R>(r)};
+} // Addition
+
+template<class L, class R, class = enable_if_t<
+        isPolynomialOperand<decay_t<L>>::value && isPolynomialOperand<decay_t<R>>::value>>
+PolynomialSum<polynomialOperand<L>, polynomialOperand<R>, -1> operator-(L &&l, R &&r) {
+    return {std::forward<L>(l), std::forward<R>(r)};
+} // Subtraction
+
+template<class E, class = enable_if_t<isPolynomialOperand<decay_t<E>>::value>>
+PolynomialScaled<polynomialOperand<E>> operator*(double s, E &&e) {
+    return {s, std::forward<E>(e)};
+} // Scalar multiplication
+
+template<class E, class = enable_if_t<isPolynomialOperand<decay_t<E>>::value>>
+PolynomialScaled<polynomialOperand<E>> operator*(E &&e, double s) {
+    return {s, std::forward<E>(e)};
+} // Scalar multiplication
+
+template<class E, class = enable_if_t<isPolynomialExpr<E>::value>>
+ostream &operator<<(ostream &out, const E &expr) {
+    return out << Polynomial(expr);
+}
+
+template<class E, class>
+Polynomial::Polynomial(const E &expr) {
+    *this = expr;
+}
+
+template<class E, class>
+Polynomial &Polynomial::operator=(const E &expr) {
+    // Fill a fresh vector first, the expression may still read from *this
+    vector<double> ans(expr.degree() + 1, 0);
+    expr.addTo(ans.data(), 1);
+    coeffs = make_shared<const vector<double>>(std::move(ans));
+    return *this;
+}
+
+inline double PolynomialView::getCoefficient(int degree) const {
+    if (degree < 0 || degree >= size)
+        return 0;
+    return data[degree];
+}
+
+inline double Polynomial::getCoefficient(int degree) const {
+    if (degree < 0 || degree >= coeffs->size())
+        return 0;
+    return (*coeffs)[degree];
+}
+
+inline void PolynomialView::addTo(double *out, double scale) const {
+    for (int i = 0; i < size; i++)
+        out[i] += scale * data[i];
+}
+
+inline void Polynomial::addTo(double *out, double scale) const {
+    const double *data = coeffs->data();
+    for (int i = 0; i < coeffs->size(); i++)
+        out[i] += scale * data[i];
+}
+
+inline const vector<double> &Polynomial::getCoefficients() const {
+    return *coeffs;
+}
+
+inline PolynomialView Polynomial::view() const {
+    return PolynomialView(*coeffs);
+}
+
 #endif // POLYNOMIAL_H
@@ -0,0 +1,220 @@
+#include "PolynomialBatch.h"
+#include "bits/stdc++.h"
+
+static const int maxFixed = PolynomialBatch::maxFixedSize;
+
+// Kernels
+
+// out = a * b for a of N and b of M coefficients, bounds known at compile time
+template<int N, int M>
+static void multiplyFixed(const double *a, const double *b, double *out) {
+    double ans[N + M - 1] = {};
+    for (int i = 0; i < N; i++)
+        for (int j = 0; j < M; j++)
+            ans[i + j] += a[i] * b[j];
+    for (int k = 0; k < N + M - 1; k++)
+        out[k] = ans[k];
+}
+
+static void multiplyGeneric(const double *a, int n, const double *b, int m, double *out) {
+    fill(out, out + n + m - 1, 0.0);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < m; j++)
+            out[i + j] += a[i] * b[j];
+}
+
+// out = r * q + c for r of Len and q of M coefficients
+template<int Len, int M>
+static void hornerStep(const double *r, const double *q, double c, double *out) {
+    for (int k = 0; k < Len + M - 1; k++)
+        out[k] = 0;
+    for (int k = 0; k < Len; k++)
+        for (int j = 0; j < M; j++)
+            out[k + j] += r[k] * q[j];
+    out[0] += c;
+}
+
+// Horner step S multiplies a partial result of S * (M - 1) + 1 coefficients by q
+template<int N, int M, size_t... S>
+static void hornerSteps(const double *a, const double *q, double *even, double *odd, index_sequence<S...>) {
+    (hornerStep<int(S) * (M - 1) + 1, M>(S % 2 ? odd : even, q, a[N - 2 - int(S)], S % 2 ? even : odd), ...);
+}
+
+// out = a(q) for a of N and q of M coefficients, by Horner on the coefficients of a
+template<int N, int M>
+static void composeFixed(const double *a, const double *q, double *out) {
+    const int size = (N - 1) * (M - 1) + 1;
+    double even[size], odd[size];
+    even[0] = a[N - 1];
+    if constexpr (N > 1)
+        hornerSteps<N, M>(a, q, even, odd, make_index_sequence<N - 1>());
+    const double *ans = (N - 1) % 2 ? odd : even;
+    for (int k = 0; k < size; k++)
+        out[k] = ans[k];
+}
+
+static void composeGeneric(const double *a, int n, const double *q, int m, double *out) {
+    vector<double> tmp((n - 1) * (m - 1) + 1);
+    int len = 1;
+    out[0] = a[n - 1];
+    for (int i = n - 2; i >= 0; i--) {
+        multiplyGeneric(out, len, q, m, tmp.data());
+        len += m - 1;
+        tmp[0] += a[i];
+        copy(tmp.begin(), tmp.begin() + len, out);
+    }
+}
+
+// Dispatch tables, entry [n - 1][m - 1] handles operands of n and m coefficients
+
+using MultiplyKernel = void (*)(const double *, const double *, double *);
+using ComposeKernel = void (*)(const double *, const double *, double *);
+
+template<int N, size_t... M>
+static constexpr array<MultiplyKernel, maxFixed> multiplyRow(index_sequence<M...>) {
+    return {multiplyFixed<N, int(M) + 1>...};
+}
+
+template<size_t... N>
+static constexpr array<array<MultiplyKernel, maxFixed>, maxFixed> multiplyTable(index_sequence<N...>) {
+    return {multiplyRow<int(N) + 1>(make_index_sequence<maxFixed>())...};
+}
+
+template<int N, size_t... M>
+static constexpr array<ComposeKernel, maxFixed> composeRow(index_sequence<M...>) {
+    return {composeFixed<N, int(M) + 1>...};
+}
+
+template<size_t... N>
+static constexpr array<array<ComposeKernel, maxFixed>, maxFixed> composeTable(index_sequence<N...>) {
+    return {composeRow<int(N) + 1>(make_index_sequence<maxFixed>())...};
+}
+
+static const auto multiplyKernels = multiplyTable(make_index_sequence<maxFixed>());
+static const auto composeKernels = composeTable(make_index_sequence<maxFixed>());
+
+// Run f(i) for every i in [0, count), split into contiguous ranges over threads
+template<class F>
+static void forEachIndex(int count, int threads, const F &f) {
+    threads = max(1, min(threads, count));
+    if (threads == 1) {
+        for (int i = 0; i < count; i++)
+            f(i);
+        return;
+    }
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        int begin = int((long long) count * t / threads), end = int((long long) count * (t + 1) / threads);
+        workers.emplace_back([&f, begin, end] {
+            for (int i = begin; i < end; i++)
+                f(i);
+        });
+    }
+    for (thread &worker: workers)
+        worker.join();
+}
+
+// Constructors
+
+PolynomialBatch::PolynomialBatch() {
+    offsets = {0};
+}
+
+PolynomialBatch::PolynomialBatch(const vector<Polynomial> &polys) {
+    offsets = {0};
+    int total = 0;
+    for (const Polynomial &p: polys)
+        total += max(1, p.degree() + 1);
+    reserve(int(polys.size()), total);
+    for (const Polynomial &p: polys)
+        push(p);
+}
+
+// Building
+
+void PolynomialBatch::push(const vector<double> &coefficients) {
+    if (coefficients.empty())
+        coeffs.push_back(0);
+    else
+        coeffs.insert(coeffs.end(), coefficients.begin(), coefficients.end());
+    offsets.push_back(int(coeffs.size()));
+}
+
+void PolynomialBatch::push(const Polynomial &poly) {
+    push(poly.getCoefficients());
+}
+
+void PolynomialBatch::reserve(int polys, int totalCoefficients) {
+    offsets.reserve(polys + 1);
+    coeffs.reserve(totalCoefficients);
+}
+
+// Access
+
+int PolynomialBatch::size() const {
+    return int(offsets.size()) - 1;
+} // Number of polynomials
+
+PolynomialView PolynomialBatch::operator[](int i) const {
+    return PolynomialView(coeffs.data() + offsets[i], offsets[i + 1] - offsets[i]);
+} // View of polynomial i
+
+Polynomial PolynomialBatch::get(int i) const {
+    return Polynomial(vector<double>(coeffs.begin() + offsets[i], coeffs.begin() + offsets[i + 1]));
+} // Copy of polynomial i
+
+// Batched operations
+
+PolynomialBatch PolynomialBatch::multiply(const PolynomialBatch &a, const PolynomialBatch &b, int threads) {
+    if (a.size() != b.size())
+        throw invalid_argument("PolynomialBatch::multiply needs batches of the same size");
+    PolynomialBatch ans;
+    ans.offsets.resize(a.size() + 1);
+    for (int i = 0; i < a.size(); i++)
+        ans.offsets[i + 1] = ans.offsets[i] + a.offsets[i + 1] - a.offsets[i] + b.offsets[i + 1] - b.offsets[i] - 1;
+    ans.coeffs.resize(ans.offsets.back());
+    forEachIndex(a.size(), threads, [&](int i) {
+        int n = a.offsets[i + 1] - a.offsets[i], m = b.offsets[i + 1] - b.offsets[i];
+        const double *x = a.coeffs.data() + a.offsets[i], *y = b.coeffs.data() + b.offsets[i];
+        double *out = ans.coeffs.data() + ans.offsets[i];
+        if (n <= maxFixed && m <= maxFixed)
+            multiplyKernels[n - 1][m - 1](x, y, out);
+        else
+            multiplyGeneric(x, n, y, m, out);
+    });
+    return ans;
+} // a[i] * b[i] for every i
+
+PolynomialBatch PolynomialBatch::compose(const PolynomialBatch &a, const PolynomialBatch &b, int threads) {
+    if (a.size() != b.size())
+        throw invalid_argument("PolynomialBatch::compose needs batches of the same size");
+    PolynomialBatch ans;
+    ans.offsets.resize(a.size() + 1);
+    for (int i = 0; i < a.size(); i++)
+        ans.offsets[i + 1] = ans.offsets[i] + (a.offsets[i + 1] - a.offsets[i] - 1) * (b.offsets[i + 1] - b.offsets[i] - 1) + 1;
+    ans.coeffs.resize(ans.offsets.back());
+    forEachIndex(a.size(), threads, [&](int i) {
+        int n = a.offsets[i + 1] - a.offsets[i], m = b.offsets[i + 1] - b.offsets[i];
+        const double *x = a.coeffs.data() + a.offsets[i], *y = b.coeffs.data() + b.offsets[i];
+        double *out = ans.coeffs.data() + ans.offsets[i];
+        if (n <= maxFixed && m <= maxFixed)
+            composeKernels[n - 1][m - 1](x, y, out);
+        else
+            composeGeneric(x, n, y, m, out);
+    });
+    return ans;
+} // a[i].compose(b[i]) for every i
+
+vector<double> PolynomialBatch::evaluate(const PolynomialBatch &polys, const vector<double> &xs, int threads) {
+    if (polys.size() != xs.size())
+        throw invalid_argument("PolynomialBatch::evaluate needs one point per polynomial");
+    vector<double> ans(xs.size());
+    forEachIndex(polys.size(), threads, [&](int i) {
+        const double *a = polys.coeffs.data() + polys.offsets[i];
+        double x = xs[i], value = 0;
+        for (int j = polys.offsets[i + 1] - polys.offsets[i] - 1; j >= 0; j--)
+            value = value * x + a[j];
+        ans[i] = value;
+    });
+    return ans;
+} // polys[i].evaluate(xs[i]) for every i
@@ -0,0 +1,48 @@
+#ifndef POLYNOMIAL_BATCH_H1
+#define POLYNOMIAL_BATCH_H1
+
+#include <vector>
+#include "Polynomial.h"
+
+using namespace std;
+
+// Many polynomials packed back to back in one buffer: polynomial i owns
+// coeffs[offsets[i]] up to coeffs[offsets[i + 1]], lowest degree first.
+//
+// multiply() and compose() work pairwise on two batches of the same size and write
+// every result into one output batch. Operand pairs of up to maxFixedSize coefficients
+// run through kernels unrolled for their exact sizes, larger ones through a generic
+// loop. evaluate() runs Horner on every polynomial at its own point, straight over the
+// packed coefficients. threads > 1 splits the batch into contiguous ranges.
+class PolynomialBatch {
+private:
+    vector<double> coeffs; // All coefficients, back to back
+    vector<int> offsets; // Start of every polynomial plus the end of the last
+
+public:
+    static const int maxFixedSize = 11; // Largest operand size with a dedicated kernel
+
+    // Constructors
+    PolynomialBatch(); // Empty batch
+    PolynomialBatch(const vector<Polynomial> &polys); // Pack the given polynomials
+
+    // Building
+    void push(const vector<double> &coefficients); // Append a polynomial
+    void push(const Polynomial &poly); // Append a polynomial
+    void reserve(int polys, int totalCoefficients); // Reserve room for a batch of this shape
+
+    // Access
+    int size() const; // Number of polynomials
+    PolynomialView operator[](int i) const; // View of polynomial i
+    Polynomial get(int i) const; // Copy of polynomial i
+
+    // Batched operations
+    static PolynomialBatch multiply(const PolynomialBatch &a, const PolynomialBatch &b,
+                                    int threads = 1); // a[i] * b[i] for every i
+    static PolynomialBatch compose(const PolynomialBatch &a, const PolynomialBatch &b,
+                                   int threads = 1); // a[i].compose(b[i]) for every i
+    static vector<double> evaluate(const PolynomialBatch &polys, const vector<double> &xs,
+                                   int threads = 1); // polys[i].evaluate(xs[i]) for every i
+};
+
+#endif // POLYNOMIAL_BATCH_H
@@ -0,0 +1,167 @@
+#include "PolynomialCache.h"
+#include "bits/stdc++.h"
+
+static size_t mix(size_t seed, uint64_t value) {
+    return seed ^ (hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+// PolynomialInternTable
+
+size_t PolynomialInternTable::hash(const vector<double> &coefficients) {
+    size_t seed = coefficients.size();
+    for (double c: coefficients) {
+        if (c == 0)
+            c = 0; // -0.0 compares equal to 0.0, so hash them alike
+        uint64_t bits;
+        memcpy(&bits, &c, sizeof bits);
+        seed = mix(seed, bits);
+    }
+    return seed;
+} // Hash consistent with operator==
+
+const PolynomialHandle::Entry *PolynomialInternTable::find(const vector<double> &coefficients, size_t hash) const {
+    auto range = byHash.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+        if (it->second->poly.getCoefficients() == coefficients)
+            return it->second;
+    return nullptr;
+}
+
+PolynomialHandle PolynomialInternTable::intern(const Polynomial &poly) {
+    const vector<double> &coefficients = poly.getCoefficients();
+    // NaN never compares equal, so every call would add another permanent entry
+    for (double c: coefficients)
+        if (isnan(c))
+            throw invalid_argument("PolynomialInternTable cannot intern NaN coefficients");
+    size_t h = hash(coefficients);
+    {
+        shared_lock<shared_mutex> guard(lock);
+        if (const PolynomialHandle::Entry *entry = find(coefficients, h))
+            return PolynomialHandle(entry);
+    }
+    unique_lock<shared_mutex> guard(lock);
+    if (const PolynomialHandle::Entry *entry = find(coefficients, h))
+        return PolynomialHandle(entry);
+    entries.push_back({poly, entries.size() + 1, h, this});
+    byHash.emplace(h, &entries.back());
+    return PolynomialHandle(&entries.back());
+} // Canonical handle for poly
+
+int PolynomialInternTable::size() const {
+    shared_lock<shared_mutex> guard(lock);
+    return int(entries.size());
+} // Number of distinct polynomials
+
+// PolynomialResultCache
+
+bool PolynomialResultCache::Key::operator==(const Key &other) const {
+    return op == other.op && a == other.a && b == other.b && guess == other.guess &&
+           tolerance == other.tolerance && maxIter == other.maxIter;
+}
+
+size_t PolynomialResultCache::KeyHash::operator()(const Key &key) const {
+    size_t seed = mix(size_t(key.op), key.a);
+    seed = mix(seed, key.b);
+    if (key.op == PolynomialOp::Root) {
+        seed = mix(seed, hash<double>()(key.guess));
+        seed = mix(seed, hash<double>()(key.tolerance));
+        seed = mix(seed, uint64_t(key.maxIter));
+    }
+    return seed;
+}
+
+PolynomialResultCache::PolynomialResultCache(const PolynomialInternTable &table, size_t capacity, int shards)
+        : table(&table), hits(0), misses(0), evictions(0) {
+    shardCount = int(max<size_t>(1, min<size_t>(max(1, shards), capacity)));
+    shardCapacity = (capacity + shardCount - 1) / shardCount;
+    this->shards.reset(new Shard[shardCount]);
+}
+
+bool PolynomialResultCache::lookup(const Key &key, Value &value) {
+    Shard &shard = shards[KeyHash()(key) % shardCount];
+    lock_guard<mutex> guard(shard.lock);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        misses++;
+        return false;
+    }
+    shard.order.splice(shard.order.begin(), shard.order, it->second);
+    value = it->second->second;
+    hits++;
+    return true;
+} // Find key and mark it recently used
+
+void PolynomialResultCache::insert(const Key &key, const Value &value) {
+    Shard &shard = shards[KeyHash()(key) % shardCount];
+    lock_guard<mutex> guard(shard.lock);
+    if (shardCapacity == 0 || shard.index.count(key))
+        return;
+    if (shard.order.size() >= shardCapacity) {
+        shard.index.erase(shard.order.back().first);
+        shard.order.pop_back();
+        evictions++;
+    }
+    shard.order.emplace_front(key, value);
+    shard.index[key] = shard.order.begin();
+} // Add key, evicting the oldest entry if full
+
+void PolynomialResultCache::check(PolynomialHandle handle) const {
+    if (handle.table() != table)
+        throw invalid_argument("PolynomialResultCache needs handles from its own intern table");
+} // Throw unless handle comes from table
+
+template<class F>
+Polynomial PolynomialResultCache::cached(const Key &key, F compute) {
+    Value value;
+    if (lookup(key, value))
+        return value.poly;
+    value = {compute(), 0};
+    insert(key, value);
+    return value.poly;
+} // Polynomial result for key
+
+Polynomial PolynomialResultCache::multiply(PolynomialHandle a, PolynomialHandle b) {
+    check(a);
+    check(b);
+    return cached({PolynomialOp::Multiply, a.id(), b.id(), 0, 0, 0}, [&] { return a.get() * b.get(); });
+} // a * b
+
+Polynomial PolynomialResultCache::compose(PolynomialHandle a, PolynomialHandle b) {
+    check(a);
+    check(b);
+    return cached({PolynomialOp::Compose, a.id(), b.id(), 0, 0, 0}, [&] { return a.get().compose(b.get()); });
+} // a.compose(b)
+
+Polynomial PolynomialResultCache::derivative(PolynomialHandle a) {
+    check(a);
+    return cached({PolynomialOp::Derivative, a.id(), 0, 0, 0, 0}, [&] { return a.get().derivative(); });
+} // a.derivative()
+
+Polynomial PolynomialResultCache::integral(PolynomialHandle a) {
+    check(a);
+    return cached({PolynomialOp::Integral, a.id(), 0, 0, 0, 0}, [&] { return a.get().integral(); });
+} // a.integral()
+
+double PolynomialResultCache::getRoot(PolynomialHandle a, double guess, double tolerance, int maxIter) {
+    check(a);
+    Key key{PolynomialOp::Root, a.id(), 0, guess, tolerance, maxIter};
+    Value value;
+    if (lookup(key, value))
+        return value.root;
+    value = {Polynomial(), a.get().getRoot(guess, tolerance, maxIter)};
+    insert(key, value);
+    return value.root;
+} // a.getRoot()
+
+PolynomialCacheStats PolynomialResultCache::stats() const {
+    return {hits.load(), misses.load(), evictions.load()};
+} // Hit, miss and eviction counts
+
+void PolynomialResultCache::clear() {
+    for (int i = 0; i < shardCount; i++) {
+        lock_guard<mutex> guard(shards[i].lock);
+        shards[i].order.clear();
+        shards[i].index.clear();
+    }
+    hits = misses = evictions = 0;
+} // Drop every entry and reset the counts
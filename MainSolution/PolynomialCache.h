@@ -0,0 +1,136 @@
+#ifndef POLYNOMIAL_CACHE_H1
+#define POLYNOMIAL_CACHE_H1
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+#include "Polynomial.h"
+
+using namespace std;
+
+class PolynomialInternTable;
+
+// Canonical, immutable polynomial owned by a PolynomialInternTable. Two handles from the
+// same table are equal exactly when their coefficient vectors are, so comparing them is a
+// pointer compare. A handle stays valid for as long as its table.
+class PolynomialHandle {
+private:
+    struct Entry {
+        Polynomial poly;
+        uint64_t id;
+        size_t hash;
+        const PolynomialInternTable *table;
+    };
+
+    const Entry *entry;
+
+    PolynomialHandle(const Entry *entry) : entry(entry) {}
+
+    friend class PolynomialInternTable;
+
+public:
+    PolynomialHandle() : entry(nullptr) {} // Null handle
+
+    const Polynomial &get() const { return entry->poly; } // The interned polynomial
+    uint64_t id() const { return entry->id; } // Dense id, unique within the table
+    const PolynomialInternTable *table() const { return entry ? entry->table : nullptr; } // Owning table, null for a null handle
+    bool operator==(const PolynomialHandle &other) const { return entry == other.entry; } // Identity
+    bool operator!=(const PolynomialHandle &other) const { return entry != other.entry; } // Identity
+};
+
+// Hash-consing table mapping coefficient vectors to their canonical handles. Entries live
+// as long as the table; polynomials with NaN coefficients are rejected with invalid_argument.
+class PolynomialInternTable {
+private:
+    mutable shared_mutex lock;
+    deque<PolynomialHandle::Entry> entries; // Stable addresses for handles
+    unordered_multimap<size_t, const PolynomialHandle::Entry *> byHash;
+
+    const PolynomialHandle::Entry *find(const vector<double> &coefficients, size_t hash) const;
+
+public:
+    PolynomialHandle intern(const Polynomial &poly); // Canonical handle for poly
+    int size() const; // Number of distinct polynomials
+
+    static size_t hash(const vector<double> &coefficients); // Hash consistent with operator==
+};
+
+enum class PolynomialOp { Multiply, Compose, Derivative, Integral, Root };
+
+struct PolynomialCacheStats {
+    uint64_t hits, misses, evictions;
+
+    double hitRate() const { return hits + misses == 0 ? 0 : double(hits) / double(hits + misses); }
+};
+
+// Bounded LRU cache of operation results on interned polynomials.
+//
+// Entries are keyed by (operation, operand ids, root-finding parameters) and spread over
+// independently locked shards, so concurrent callers only contend when they land on the
+// same shard. The capacity is split evenly between the shards and each evicts its own
+// least recently used entry, so the LRU order is only approximate: a shard can evict while
+// others still have room, long before the cache as a whole is full. A miss computes outside the lock; two threads missing on the same key both
+// compute it and the second insert is a no-op. Results are kept as plain Polynomials and
+// are not interned, so an evicted result frees its memory; pass one to table.intern()
+// when a handle is needed. Keys use handle ids, so a cache is tied to one intern table and
+// throws invalid_argument for null handles or handles from any other table. A capacity of
+// 0 disables caching.
+class PolynomialResultCache {
+private:
+    struct Key {
+        PolynomialOp op;
+        uint64_t a, b;
+        double guess, tolerance;
+        int maxIter;
+
+        bool operator==(const Key &other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Value {
+        Polynomial poly;
+        double root;
+    };
+
+    struct Shard {
+        mutex lock;
+        list<pair<Key, Value>> order; // Most recently used first
+        unordered_map<Key, list<pair<Key, Value>>::iterator, KeyHash> index;
+    };
+
+    const PolynomialInternTable *table;
+    size_t shardCapacity;
+    unique_ptr<Shard[]> shards;
+    int shardCount;
+    atomic<uint64_t> hits, misses, evictions;
+
+    bool lookup(const Key &key, Value &value); // Find key and mark it recently used
+    void insert(const Key &key, const Value &value); // Add key, evicting the oldest entry if full
+
+    void check(PolynomialHandle handle) const; // Throw unless handle comes from table
+    template<class F>
+    Polynomial cached(const Key &key, F compute); // Polynomial result for key
+
+public:
+    PolynomialResultCache(const PolynomialInternTable &table, size_t capacity, int shards = 16); // Constructor
+
+    Polynomial multiply(PolynomialHandle a, PolynomialHandle b); // a * b
+    Polynomial compose(PolynomialHandle a, PolynomialHandle b); // a.compose(b)
+    Polynomial derivative(PolynomialHandle a); // a.derivative()
+    Polynomial integral(PolynomialHandle a); // a.integral()
+    double getRoot(PolynomialHandle a, double guess = 1, double tolerance = 1e-6, int maxIter = 100); // a.getRoot()
+
+    PolynomialCacheStats stats() const; // Hit, miss and eviction counts
+    void clear(); // Drop every entry and reset the counts
+};
+
+#endif // POLYNOMIAL_CACHE_H
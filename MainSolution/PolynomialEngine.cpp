@@ -0,0 +1,154 @@
+#include "PolynomialEngine.h"
+#include "PolynomialBatch.h"
+#include "bits/stdc++.h"
+
+PolynomialEngine::PolynomialEngine(const PolynomialEngineConfig &config)
+        : config(config), queue(config.queueCapacity), stopping(false), sleepers(0), jobs(0), batches(0), maxBatch(0) {
+    this->config.maxBatch = max(1, config.maxBatch);
+    for (int i = 0; i < max(1, config.workers); i++)
+        workers.emplace_back(&PolynomialEngine::work, this);
+}
+
+PolynomialEngine::~PolynomialEngine() {
+    {
+        lock_guard<mutex> guard(idleLock);
+        stopping = true;
+    }
+    idle.notify_all();
+    for (thread &worker: workers)
+        worker.join();
+}
+
+// Submission
+
+void PolynomialEngine::submit(Job *job) {
+    while (!queue.tryPush(job))
+        this_thread::yield();
+    // Pairs with the fence in waitForJob: either the worker sees the job or we see the worker
+    atomic_thread_fence(memory_order_seq_cst);
+    if (sleepers.load() > 0) {
+        lock_guard<mutex> guard(idleLock);
+        idle.notify_one();
+    }
+} // Queue job, waiting while the queue is full
+
+future<double> PolynomialEngine::evaluate(const Polynomial &p, double x) {
+    Job *job = new Job(Kind::Evaluate, p, Polynomial(), x, 0, 0);
+    future<double> ans = job->number.get_future();
+    submit(job);
+    return ans;
+} // p.evaluate(x)
+
+future<Polynomial> PolynomialEngine::multiply(const Polynomial &a, const Polynomial &b) {
+    Job *job = new Job(Kind::Multiply, a, b, 0, 0, 0);
+    future<Polynomial> ans = job->poly.get_future();
+    submit(job);
+    return ans;
+} // a * b
+
+future<double> PolynomialEngine::getRoot(const Polynomial &p, double guess, double tolerance, int maxIter) {
+    Job *job = new Job(Kind::Root, p, Polynomial(), guess, tolerance, maxIter);
+    future<double> ans = job->number.get_future();
+    submit(job);
+    return ans;
+} // p.getRoot(guess, tolerance, maxIter)
+
+// Workers
+
+bool PolynomialEngine::waitForJob(chrono::steady_clock::time_point deadline) {
+    unique_lock<mutex> guard(idleLock);
+    sleepers++;
+    atomic_thread_fence(memory_order_seq_cst);
+    auto ready = [this] { return stopping || queue.sizeApprox() > 0; };
+    bool woken = deadline == chrono::steady_clock::time_point::max() ? (idle.wait(guard, ready), true)
+                                                                      : idle.wait_until(guard, deadline, ready);
+    sleepers--;
+    return woken && !stopping;
+} // Block until a job is queued or deadline
+
+void PolynomialEngine::work() {
+    vector<Job *> batch;
+    Job *job;
+    while (true) {
+        if (!queue.tryPop(job)) {
+            if (stopping)
+                return;
+            waitForJob(chrono::steady_clock::time_point::max());
+            continue;
+        }
+        batch.assign(1, job);
+        // Time spent queued counts too, a job already past its deadline only takes what is queued
+        auto deadline = job->submitted + config.maxLatency;
+        while (batch.size() < config.maxBatch) {
+            if (queue.tryPop(job))
+                batch.push_back(job);
+            else if (stopping || !waitForJob(deadline))
+                break;
+        }
+        run(batch);
+    }
+} // Worker loop
+
+void PolynomialEngine::run(vector<Job *> &batch) {
+    vector<Job *> evaluates, multiplies, roots;
+    for (Job *job: batch) {
+        if (job->kind == Kind::Evaluate)
+            evaluates.push_back(job);
+        else if (job->kind == Kind::Multiply)
+            multiplies.push_back(job);
+        else
+            roots.push_back(job);
+    }
+    if (!evaluates.empty()) {
+        int done = 0; // Promises already fulfilled, which must not be set again
+        try {
+            PolynomialBatch polys;
+            vector<double> xs;
+            for (Job *job: evaluates) {
+                polys.push(job->a);
+                xs.push_back(job->x);
+            }
+            vector<double> values = PolynomialBatch::evaluate(polys, xs);
+            for (; done < evaluates.size(); done++)
+                evaluates[done]->number.set_value(values[done]);
+        } catch (...) {
+            for (int i = done; i < evaluates.size(); i++)
+                evaluates[i]->number.set_exception(current_exception());
+        }
+    }
+    if (!multiplies.empty()) {
+        int done = 0; // Promises already fulfilled, which must not be set again
+        try {
+            PolynomialBatch a, b;
+            for (Job *job: multiplies) {
+                a.push(job->a);
+                b.push(job->b);
+            }
+            PolynomialBatch product = PolynomialBatch::multiply(a, b);
+            for (; done < multiplies.size(); done++)
+                multiplies[done]->poly.set_value(product.get(done));
+        } catch (...) {
+            for (int i = done; i < multiplies.size(); i++)
+                multiplies[i]->poly.set_exception(current_exception());
+        }
+    }
+    // Newton iterations differ per job, so roots run one by one
+    for (Job *job: roots) {
+        try {
+            job->number.set_value(job->a.getRoot(job->x, job->tolerance, job->maxIter));
+        } catch (...) {
+            job->number.set_exception(current_exception());
+        }
+    }
+
+    jobs += batch.size();
+    batches++;
+    uint64_t largest = maxBatch.load();
+    while (largest < batch.size() && !maxBatch.compare_exchange_weak(largest, batch.size()));
+    for (Job *job: batch)
+        delete job;
+} // Run one batch and fulfil its promises
+
+PolynomialEngineStats PolynomialEngine::stats() const {
+    return {queue.sizeApprox(), jobs.load(), batches.load(), maxBatch.load()};
+} // Queue depth and batch sizes
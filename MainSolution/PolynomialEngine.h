@@ -0,0 +1,88 @@
+#ifndef POLYNOMIAL_ENGINE_H1
+#define POLYNOMIAL_ENGINE_H1
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "MpmcQueue.h"
+#include "Polynomial.h"
+
+using namespace std;
+
+struct PolynomialEngineConfig {
+    int workers = 2; // Worker threads
+    size_t queueCapacity = 4096; // Pending jobs before submitters have to wait
+    int maxBatch = 64; // Most jobs a worker takes at once
+    chrono::microseconds maxLatency = chrono::microseconds(200); // How long a batch may wait to fill up
+};
+
+struct PolynomialEngineStats {
+    size_t queueDepth; // Jobs waiting right now
+    uint64_t jobs; // Jobs completed
+    uint64_t batches; // Batches run
+    uint64_t maxBatch; // Largest batch run
+
+    double averageBatch() const { return batches == 0 ? 0 : double(jobs) / double(batches); }
+};
+
+// Runs evaluate, multiply and root-finding jobs submitted from any thread.
+//
+// Submissions go through a lock-free queue and return a future right away. A worker
+// takes the first waiting job, keeps pulling until it has maxBatch jobs or the first
+// one is maxLatency past its submission, then runs the jobs grouped by kind:
+// evaluations as one PolynomialBatch::evaluate call, multiplications as one
+// PolynomialBatch::multiply call, and roots one after another since each takes its own
+// number of Newton steps. The destructor finishes every job already submitted.
+class PolynomialEngine {
+private:
+    enum class Kind { Evaluate, Multiply, Root };
+
+    struct Job {
+        Kind kind;
+        Polynomial a, b;
+        double x, tolerance;
+        int maxIter;
+        promise<double> number;
+        promise<Polynomial> poly;
+        chrono::steady_clock::time_point submitted; // Start of the job's latency budget
+
+        Job(Kind kind, const Polynomial &a, const Polynomial &b, double x, double tolerance, int maxIter)
+                : kind(kind), a(a), b(b), x(x), tolerance(tolerance), maxIter(maxIter),
+                  submitted(chrono::steady_clock::now()) {} // Constructor
+    };
+
+    PolynomialEngineConfig config;
+    MpmcQueue<Job *> queue;
+    vector<thread> workers;
+    atomic<bool> stopping;
+    mutex idleLock;
+    condition_variable idle;
+    atomic<int> sleepers; // Workers blocked on idle, submitters only notify when nonzero
+    atomic<uint64_t> jobs, batches, maxBatch;
+
+    void submit(Job *job); // Queue job, waiting while the queue is full
+    void work(); // Worker loop
+    bool waitForJob(chrono::steady_clock::time_point deadline); // Block until a job is queued or deadline
+    void run(vector<Job *> &batch); // Run one batch and fulfil its promises
+
+public:
+    PolynomialEngine(const PolynomialEngineConfig &config = PolynomialEngineConfig()); // Start the workers
+    ~PolynomialEngine(); // Drain the queue and stop the workers
+
+    PolynomialEngine(const PolynomialEngine &) = delete;
+    PolynomialEngine &operator=(const PolynomialEngine &) = delete;
+
+    future<double> evaluate(const Polynomial &p, double x); // p.evaluate(x)
+    future<Polynomial> multiply(const Polynomial &a, const Polynomial &b); // a * b
+    future<double> getRoot(const Polynomial &p, double guess = 1, double tolerance = 1e-6,
+                           int maxIter = 100); // p.getRoot(guess, tolerance, maxIter)
+
+    PolynomialEngineStats stats() const; // Queue depth and batch sizes
+};
+
+#endif // POLYNOMIAL_ENGINE_H